@@ -0,0 +1,225 @@
+// XH-CppUtilities
+// C++20 call_buffer.h
+// Author: xupeigong@sjtu.edu.cn
+// Last Updated: 2026-10-19
+
+#ifndef _XH_CALL_BUFFER_H_
+#define _XH_CALL_BUFFER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <new>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "function_traits.h"
+
+namespace xh {
+
+using namespace std;
+
+// call buffer
+
+template <class T>
+inline constexpr bool _is_mutable_lref_v =
+  is_lvalue_reference_v<T> && !is_const_v<remove_reference_t<T>>;
+
+template <class T>
+using _call_param_t = conditional_t<_is_mutable_lref_v<T>,
+  reference_wrapper<remove_reference_t<T>>, remove_cvref_t<T>>;
+
+template <class T, class Arg>
+inline constexpr bool _call_bindable_v = !_is_mutable_lref_v<T> ||
+  is_same_v<decay_t<Arg>, reference_wrapper<remove_reference_t<T>>>;
+
+template <class>
+struct _call_storage;
+
+template <class... Args>
+struct _call_storage<tuple<Args...>> {
+  using type = tuple<_call_param_t<Args>...>;
+};
+
+template <class T>
+using _call_storage_t = _call_storage<funcarg_tuple<T>>::type;
+
+class call_buffer {
+ public:
+  explicit call_buffer(size_t block_size = 64 * 1024) noexcept
+    : block_size(block_size) {}
+
+  call_buffer(const call_buffer &) = delete;
+  call_buffer(call_buffer &&r) noexcept
+    : blocks(move(r.blocks)), current(exchange(r.current, 0)),
+      count(exchange(r.count, 0)), block_size(r.block_size) {}
+  ~call_buffer() noexcept { clear(); }
+  call_buffer &operator=(const call_buffer &) = delete;
+
+  call_buffer &operator=(call_buffer &&r) noexcept {
+    if (this != &r) {
+      clear();
+      blocks = move(r.blocks);
+      current = exchange(r.current, 0);
+      count = exchange(r.count, 0);
+      block_size = r.block_size;
+    }
+    return *this;
+  }
+
+  size_t size() const noexcept { return count; }
+  bool empty() const noexcept { return !count; }
+
+  template <class F, class... Args>
+    requires ((is_funcptr_v<decay_t<F>> || is_functor_v<decay_t<F>>) &&
+              sizeof...(Args) == funcarity_v<F> &&
+              is_constructible_v<_call_storage_t<F>, Args &&...>)
+  void record(F &&f, Args &&...args) {
+    using record_type = call_record<decay_t<F>, _call_storage_t<F>>;
+    static_assert([]<size_t... I>(index_sequence<I...>) {
+      return (_call_bindable_v<funcarg_t<F, I>, Args> && ...);
+    }(index_sequence_for<Args...>{}),
+      "Non-const lvalue reference parameters must be bound with std::ref");
+    static_assert(alignof(record_type) <= align,
+                  "Over-aligned call records are not supported");
+    constexpr size_t n = round_up(header_size + sizeof(record_type));
+    byte *p = acquire(n);
+    ::new (p + header_size)
+      record_type{forward<F>(f), _call_storage_t<F>(forward<Args>(args)...)};
+    ::new (p) header{&run<record_type>, n};
+    blocks[current].used += n;
+    ++count;
+  }
+
+  void replay() { drain(true); }
+  void clear() noexcept { drain(false); }
+
+ private:
+  static constexpr size_t align = alignof(max_align_t);
+
+  struct header {
+    void (*run)(void *, bool);
+    size_t size;
+  };
+
+  template <class F, class Tuple>
+  struct call_record {
+    F f;
+    Tuple args;
+  };
+
+  struct block {
+    unique_ptr<byte[]> data;
+    size_t capacity = 0;
+    size_t used = 0;
+  };
+
+  static constexpr size_t round_up(size_t n) noexcept {
+    return (n + align - 1) / align * align;
+  }
+
+  static constexpr size_t header_size =
+    (sizeof(header) + align - 1) / align * align;
+
+  vector<block> blocks;
+  size_t current = 0;
+  size_t count = 0;
+  size_t block_size;
+
+  template <class R>
+  static void run(void *p, bool invoke) {
+    R *r = static_cast<R *>(p);
+    struct guard {
+      R *r;
+      ~guard() noexcept { r->~R(); }
+    } g{r};
+    if (invoke)
+      call(*r, make_index_sequence<tuple_size_v<decltype(r->args)>>{});
+  }
+
+  template <class R, size_t... I>
+  static void call(R &r, index_sequence<I...>) {
+    using F = decltype(r.f);
+    r.f(unwrap<funcarg_t<F, I>>(get<I>(r.args))...);
+  }
+
+  template <class T, class U>
+  static decltype(auto) unwrap(U &arg) noexcept {
+    if constexpr (_is_mutable_lref_v<T>) return arg.get();
+    else return forward<T>(arg);
+  }
+
+  byte *acquire(size_t n) {
+    for (; current < blocks.size(); ++current)
+      if (blocks[current].capacity - blocks[current].used >= n)
+        return blocks[current].data.get() + blocks[current].used;
+    size_t capacity = max(n, block_size);
+    blocks.push_back({unique_ptr<byte[]>(new byte[capacity]), capacity});
+    current = blocks.size() - 1;
+    return blocks[current].data.get();
+  }
+
+  header *at(size_t i, size_t off) noexcept {
+    return launder(reinterpret_cast<header *>(blocks[i].data.get() + off));
+  }
+
+  void drain(bool invoke) {
+    struct guard {
+      call_buffer &cb;
+      size_t i = 0, off = 0;
+      ~guard() noexcept {
+        for (; i < cb.blocks.size(); ++i, off = 0)
+          while (off < cb.blocks[i].used) {
+            header *h = cb.at(i, off);
+            off += h->size;
+            h->run(reinterpret_cast<byte *>(h) + header_size, false);
+          }
+        for (auto &b : cb.blocks) b.used = 0;
+        cb.current = cb.count = 0;
+      }
+    } g{*this};
+    if (invoke)
+      for (; g.i < blocks.size(); ++g.i, g.off = 0)
+        while (g.off < blocks[g.i].used) {
+          header *h = at(g.i, g.off);
+          g.off += h->size;
+          h->run(reinterpret_cast<byte *>(h) + header_size, true);
+        }
+  }
+};
+
+inline void replay_parallel(span<call_buffer> buffers,
+                            size_t threads = thread::hardware_concurrency()) {
+  if (buffers.empty()) return;
+  threads = clamp<size_t>(threads, 1, buffers.size());
+  atomic<size_t> next = 0;
+  exception_ptr error;
+  atomic_flag failed;
+  auto worker = [&] {
+    for (size_t i; (i = next.fetch_add(1)) < buffers.size();) {
+      try {
+        buffers[i].replay();
+      } catch (...) {
+        if (!failed.test_and_set()) error = current_exception();
+      }
+    }
+  };
+  {
+    vector<jthread> pool;
+    pool.reserve(threads - 1);
+    for (size_t i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+  }
+  if (error) rethrow_exception(error);
+}
+
+} // namespace xh
+
+#endif // !_XH_CALL_BUFFER_H_
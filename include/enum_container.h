@@ -0,0 +1,347 @@
+// XH-CppUtilities
+// C++20 enum_container.h
+// Author: xupeigong@sjtu.edu.cn
+// Last Updated: 2026-10-19
+
+#ifndef _XH_ENUM_CONTAINER_H_
+#define _XH_ENUM_CONTAINER_H_
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "enum_name.h"
+
+namespace xh {
+
+using namespace std;
+
+// enum bits
+
+template <class E>
+inline constexpr size_t _enum_words_v =
+  max<size_t>(1, (enum_count_v<E> + 63) / 64);
+
+template <class E, size_t Limit = 256>
+constexpr bool _enum_contiguous() {
+  constexpr size_t num = enum_count_v<E>;
+  constexpr auto top = static_cast<size_t>(
+    numeric_limits<underlying_type_t<E>>::max());
+  constexpr size_t end = top < Limit ? top + 1 : Limit;
+  if constexpr (num == 0 || num >= end) return num != 0;
+  else return []<size_t... N>(index_sequence<N...>) {
+    return (enum_name<static_cast<E>(num + N)>().empty() && ...);
+  }(make_index_sequence<end - num>{});
+}
+
+template <class E>
+inline constexpr bool _enum_contiguous_v = _enum_contiguous<E>();
+
+template <class E>
+constexpr size_t _enum_index(E key) noexcept {
+  assert(static_cast<size_t>(key) < enum_count_v<E>);
+  return static_cast<size_t>(key);
+}
+
+template <class E>
+constexpr size_t _enum_next_bit(const uint64_t *words, size_t i) noexcept {
+  constexpr size_t num = enum_count_v<E>;
+  while (i < num) {
+    if (uint64_t bits = words[i / 64] >> (i % 64))
+      return i + countr_zero(bits) < num ? i + countr_zero(bits) : num;
+    i = (i / 64 + 1) * 64;
+  }
+  return num;
+}
+
+// enum entry
+
+template <class E, class V>
+struct enum_entry {
+  E key;
+  string_view name;
+  V &value;
+};
+
+template <class E, class V>
+class enum_entry_iterator {
+ public:
+  using value_type = enum_entry<E, V>;
+  using difference_type = ptrdiff_t;
+
+  constexpr enum_entry_iterator() noexcept = default;
+  constexpr enum_entry_iterator(V *values, const uint64_t *words, size_t i)
+    noexcept : values(values), words(words), i(words ? next(i) : i) {}
+
+  constexpr value_type operator*() const noexcept {
+    return {static_cast<E>(i), enum_names_v<E>[i], values[i]};
+  }
+
+  constexpr enum_entry_iterator &operator++() noexcept {
+    i = words ? next(i + 1) : i + 1;
+    return *this;
+  }
+
+  constexpr enum_entry_iterator operator++(int) noexcept {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  constexpr bool operator==(const enum_entry_iterator &r) const noexcept {
+    return i == r.i;
+  }
+
+ private:
+  V *values = nullptr;
+  const uint64_t *words = nullptr;
+  size_t i = 0;
+
+  constexpr size_t next(size_t from) const noexcept {
+    return _enum_next_bit<E>(words, from);
+  }
+};
+
+// enum set
+
+template <class E> requires is_enum_v<E>
+class enum_set {
+ public:
+  static_assert(_enum_contiguous_v<E>,
+                "Enumerators must be contiguous and start at 0");
+
+  using key_type = E;
+
+  class iterator {
+   public:
+    using value_type = E;
+    using difference_type = ptrdiff_t;
+
+    constexpr iterator() noexcept = default;
+    constexpr iterator(const uint64_t *words, size_t i) noexcept
+      : words(words), i(_enum_next_bit<E>(words, i)) {}
+
+    constexpr E operator*() const noexcept { return static_cast<E>(i); }
+
+    constexpr iterator &operator++() noexcept {
+      i = _enum_next_bit<E>(words, i + 1);
+      return *this;
+    }
+
+    constexpr iterator operator++(int) noexcept {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    constexpr bool operator==(const iterator &r) const noexcept {
+      return i == r.i;
+    }
+
+   private:
+    const uint64_t *words = nullptr;
+    size_t i = 0;
+  };
+
+  constexpr enum_set() noexcept = default;
+  constexpr enum_set(initializer_list<E> keys) noexcept {
+    for (E key : keys) insert(key);
+  }
+
+  constexpr enum_set(const enum_set &) noexcept = default;
+  constexpr enum_set(enum_set &&) noexcept = default;
+  constexpr ~enum_set() noexcept = default;
+  constexpr enum_set &operator=(const enum_set &) noexcept = default;
+  constexpr enum_set &operator=(enum_set &&) noexcept = default;
+
+  constexpr bool contains(E key) const noexcept {
+    return words[index(key) / 64] >> (index(key) % 64) & 1;
+  }
+
+  constexpr void insert(E key) noexcept {
+    words[index(key) / 64] |= uint64_t{1} << (index(key) % 64);
+  }
+
+  constexpr void erase(E key) noexcept {
+    words[index(key) / 64] &= ~(uint64_t{1} << (index(key) % 64));
+  }
+
+  constexpr void clear() noexcept {
+    for (auto &w : words) w = 0;
+  }
+
+  constexpr size_t size() const noexcept {
+    size_t n = 0;
+    for (auto w : words) n += popcount(w);
+    return n;
+  }
+
+  constexpr bool empty() const noexcept {
+    for (auto w : words) if (w) return false;
+    return true;
+  }
+
+  static constexpr size_t max_size() noexcept { return enum_count_v<E>; }
+
+  constexpr enum_set &operator|=(const enum_set &r) noexcept {
+    for (size_t i = 0; i < _enum_words_v<E>; ++i) words[i] |= r.words[i];
+    return *this;
+  }
+
+  constexpr enum_set &operator&=(const enum_set &r) noexcept {
+    for (size_t i = 0; i < _enum_words_v<E>; ++i) words[i] &= r.words[i];
+    return *this;
+  }
+
+  friend constexpr enum_set operator|(enum_set l, const enum_set &r) noexcept {
+    return l |= r;
+  }
+
+  friend constexpr enum_set operator&(enum_set l, const enum_set &r) noexcept {
+    return l &= r;
+  }
+
+  constexpr bool operator==(const enum_set &) const noexcept = default;
+
+  constexpr iterator begin() const noexcept { return {words, 0}; }
+  constexpr iterator end() const noexcept { return {words, max_size()}; }
+
+ private:
+  template <class K, class V> requires is_enum_v<K>
+  friend class enum_map;
+
+  uint64_t words[_enum_words_v<E>] = {};
+
+  static constexpr size_t index(E key) noexcept {
+    return _enum_index(key);
+  }
+};
+
+// enum array
+
+template <class E, class V> requires is_enum_v<E>
+struct enum_array {
+  static_assert(_enum_contiguous_v<E>,
+                "Enumerators must be contiguous and start at 0");
+
+  using key_type = E;
+  using mapped_type = V;
+  using iterator = enum_entry_iterator<E, V>;
+  using const_iterator = enum_entry_iterator<E, const V>;
+
+  V elems[enum_count_v<E>];
+
+  constexpr V &operator[](E key) noexcept {
+    return elems[_enum_index(key)];
+  }
+
+  constexpr const V &operator[](E key) const noexcept {
+    return elems[_enum_index(key)];
+  }
+
+  static constexpr size_t size() noexcept { return enum_count_v<E>; }
+
+  constexpr V *data() noexcept { return elems; }
+  constexpr const V *data() const noexcept { return elems; }
+
+  constexpr void fill(const V &value) {
+    for (auto &e : elems) e = value;
+  }
+
+  constexpr iterator begin() noexcept { return {elems, nullptr, 0}; }
+  constexpr iterator end() noexcept { return {elems, nullptr, size()}; }
+  constexpr const_iterator begin() const noexcept {
+    return {elems, nullptr, 0};
+  }
+  constexpr const_iterator end() const noexcept {
+    return {elems, nullptr, size()};
+  }
+};
+
+// enum map
+
+template <class E, class V> requires is_enum_v<E>
+class enum_map {
+ public:
+  static_assert(_enum_contiguous_v<E>,
+                "Enumerators must be contiguous and start at 0");
+
+  using key_type = E;
+  using mapped_type = V;
+  using iterator = enum_entry_iterator<E, V>;
+  using const_iterator = enum_entry_iterator<E, const V>;
+
+  constexpr enum_map() = default;
+  constexpr enum_map(initializer_list<pair<E, V>> entries) {
+    for (auto &[key, value] : entries) insert_or_assign(key, value);
+  }
+
+  constexpr enum_map(const enum_map &) = default;
+  constexpr enum_map(enum_map &&) noexcept = default;
+  constexpr ~enum_map() noexcept = default;
+  constexpr enum_map &operator=(const enum_map &) = default;
+  constexpr enum_map &operator=(enum_map &&) noexcept = default;
+
+  constexpr V &operator[](E key) noexcept {
+    _keys.insert(key);
+    return values[_enum_index(key)];
+  }
+
+  template <class T>
+  constexpr void insert_or_assign(E key, T &&value) {
+    values[_enum_index(key)] = forward<T>(value);
+    _keys.insert(key);
+  }
+
+  constexpr V *find(E key) noexcept {
+    return contains(key) ? &values[_enum_index(key)] : nullptr;
+  }
+
+  constexpr const V *find(E key) const noexcept {
+    return contains(key) ? &values[_enum_index(key)] : nullptr;
+  }
+
+  constexpr bool contains(E key) const noexcept { return _keys.contains(key); }
+
+  constexpr void erase(E key) {
+    values[_enum_index(key)] = V{};
+    _keys.erase(key);
+  }
+
+  constexpr void clear() {
+    for (E key : _keys) values[_enum_index(key)] = V{};
+    _keys.clear();
+  }
+
+  constexpr size_t size() const noexcept { return _keys.size(); }
+  constexpr bool empty() const noexcept { return _keys.empty(); }
+  static constexpr size_t max_size() noexcept { return enum_count_v<E>; }
+  constexpr const enum_set<E> &keys() const noexcept { return _keys; }
+
+  constexpr iterator begin() noexcept { return {values, _keys.words, 0}; }
+  constexpr iterator end() noexcept {
+    return {values, _keys.words, max_size()};
+  }
+  constexpr const_iterator begin() const noexcept {
+    return {values, _keys.words, 0};
+  }
+  constexpr const_iterator end() const noexcept {
+    return {values, _keys.words, max_size()};
+  }
+
+ private:
+  V values[enum_count_v<E>] = {};
+  enum_set<E> _keys;
+};
+
+} // namespace xh
+
+#endif // !_XH_ENUM_CONTAINER_H_
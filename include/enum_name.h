@@ -1,13 +1,15 @@
 // XH-CppUtilities
 // C++20 enum_name.h
 // Author: xupeigong@sjtu.edu.cn
-// Last Updated: 2024-09-12
+// Last Updated: 2026-10-19
 
 #ifndef _XH_ENUM_NAME_H_
 #define _XH_ENUM_NAME_H_
 
+#include <array>
 #include <string_view>
 #include <type_traits>
+#include <utility>
 
 namespace xh {
 
@@ -37,13 +39,17 @@ constexpr auto enum_max() {
   return N;
 }
 
+template<typename T> requires is_enum_v<T>
+inline constexpr size_t enum_count_v = enum_max<T>();
+
+template<typename T> requires is_enum_v<T>
+inline constexpr auto enum_names_v = []<size_t... N>(index_sequence<N...>) {
+  return array<string_view, sizeof...(N)>{enum_name<static_cast<T>(N)>()...};
+}(make_index_sequence<enum_count_v<T>>{});
+
 template<typename T> requires is_enum_v<T>
 constexpr auto enum_name(T value) {
-  constexpr auto num = enum_max<T>();
-  constexpr auto names = []<size_t... N>(index_sequence<N...>) {
-    return array<string_view, num>{enum_name<static_cast<T>(N)>()...};
-  }(make_index_sequence<num>{});
-  return names[static_cast<size_t>(value)];
+  return enum_names_v<T>[static_cast<size_t>(value)];
 }
 
 };
@@ -1,12 +1,18 @@
 // XH-CppUtilities
 // C++20 function_utility.h
 // Author: xupeigong@sjtu.edu.cn, 1583913466@qq.com
-// Last Updated: 2024-09-12
+// Last Updated: 2026-10-19
 
 #ifndef _XH_FUNCTION_UTILITY_H_
 #define _XH_FUNCTION_UTILITY_H_
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 
@@ -37,7 +43,8 @@ class function<MFP> {
   template <class Arg0, class... Args>
     requires is_invocable_v<MFP, Arg0, Args...>
   funcret_t<MFP> operator()(Arg0 &&arg0, Args &&...args) const
-    noexcept(funcqual_of_v<mffunction_t<MFP>> & funcqual_mask::noexcept_mask) {
+    noexcept(bool(funcqual_of_v<mffunction_t<MFP>> &
+                  +funcqual_mask::noexcept_mask)) {
     if constexpr (is_pointer_v<decay_t<Arg0>>)
       return (forward<Arg0>(arg0)->*_mfp)(forward<Args>(args)...);
     else return (forward<Arg0>(arg0).*_mfp)(forward<Args>(args)...);
@@ -83,9 +90,33 @@ class function<Ret(Args...)> {
     return fbp->call(forward<Args>(args)...);
   }
 
+ private:
+  using batch_arg_t = remove_cvref_t<nth_of_t<0, Args..., void>>;
+  using batch_ret_t = remove_cvref_t<Ret>;
+
+ public:
+  static constexpr bool is_batchable_v = sizeof...(Args) == 1 &&
+    is_convertible_v<add_lvalue_reference_t<const batch_arg_t>,
+                     nth_of_t<0, Args..., void>> &&
+    (is_void_v<Ret> || is_assignable_v<add_lvalue_reference_t<batch_ret_t>,
+                                       Ret>);
+
+  void invoke_batch(span<const batch_arg_t> in, span<batch_ret_t> out) const
+    requires (is_batchable_v && !is_void_v<Ret>) {
+    assert(in.size() == out.size());
+    fbp->call_batch(in.data(), out.data(), min(in.size(), out.size()));
+  }
+
+  void invoke_batch(span<const batch_arg_t> in) const
+    requires (is_batchable_v && is_void_v<Ret>) {
+    fbp->call_batch(in.data(), nullptr, in.size());
+  }
+
  private:
   struct funcbase {
     virtual Ret call(Args...) const = 0;
+    virtual void call_batch(const batch_arg_t *, batch_ret_t *,
+                            size_t) const = 0;
     virtual funcbase *copy() const noexcept = 0;
     virtual ~funcbase() noexcept = default;
   } *fbp = nullptr;
@@ -97,6 +128,18 @@ class function<Ret(Args...)> {
     funcimpl(F &&f) : f(forward<F>(f)) {}
 
     Ret call(Args... args) const override { return f(forward<Args>(args)...); }
+
+    void call_batch(const batch_arg_t *in, batch_ret_t *out,
+                    size_t n) const override {
+      if constexpr (is_batchable_v) {
+        using arg_type = nth_of_t<0, Args...>;
+        if constexpr (is_void_v<Ret>)
+          for (size_t i = 0; i < n; ++i) f(static_cast<arg_type>(in[i]));
+        else for (size_t i = 0; i < n; ++i)
+          out[i] = f(static_cast<arg_type>(in[i]));
+      }
+    }
+
     funcimpl *copy() const noexcept override { return new funcimpl(f); }
     ~funcimpl() noexcept override = default;
   };
@@ -105,6 +148,196 @@ class function<Ret(Args...)> {
 template <class T>
 function(T) -> function<functraits_t<T>>;
 
+// read epoch
+
+class _read_epoch {
+ public:
+  class guard {
+   public:
+    guard(const _read_epoch &ep) noexcept : ep(ep), e(ep.epoch.load()) {
+      ep.readers[e].n.fetch_add(1);
+    }
+    ~guard() noexcept { ep.readers[e].n.fetch_sub(1); }
+   private:
+    const _read_epoch &ep;
+    size_t e;
+  };
+
+  void synchronize() const {
+    lock_guard lock(wm);
+    for (int i = 0; i < 2; ++i) {
+      size_t e = epoch.load();
+      epoch.store(e ^ 1);
+      while (readers[e].n.load()) this_thread::yield();
+    }
+  }
+
+ private:
+  struct alignas(64) counter {
+    atomic<size_t> n = 0;
+  };
+
+  mutable atomic<size_t> epoch = 0;
+  mutable counter readers[2];
+  mutable mutex wm;
+};
+
+// atomic function
+
+template <class>
+class atomic_function;
+
+template <class Ret, class... Args>
+class atomic_function<Ret(Args...)> {
+ public:
+  using function_type = xh::function<Ret(Args...)>;
+
+  template <class T> requires (!is_same_v<decay_t<T>, atomic_function>)
+  atomic_function(T &&f) : fp(new function_type(forward<T>(f))) {}
+
+  atomic_function() noexcept = default;
+  atomic_function(const atomic_function &) = delete;
+  atomic_function(atomic_function &&) = delete;
+  ~atomic_function() noexcept { delete fp.load(); }
+  atomic_function &operator=(const atomic_function &) = delete;
+  atomic_function &operator=(atomic_function &&) = delete;
+
+  template <class T> requires (!is_same_v<decay_t<T>, atomic_function>)
+  atomic_function &operator=(T &&f) {
+    store(forward<T>(f));
+    return *this;
+  }
+
+  // Writers wait for in-flight calls, so a target must not store into
+  // the slot it is being called through.
+  template <class T> requires (!is_same_v<decay_t<T>, atomic_function>)
+  void store(T &&f) { delete retire(new function_type(forward<T>(f))); }
+
+  template <class T> requires (!is_same_v<decay_t<T>, atomic_function>)
+  function_type exchange(T &&f) {
+    function_type *old = retire(new function_type(forward<T>(f)));
+    function_type ret = old ? move(*old) : function_type{};
+    delete old;
+    return ret;
+  }
+
+  function_type load() const {
+    _read_epoch::guard guard(ep);
+    const function_type *p = fp.load();
+    return p ? *p : function_type{};
+  }
+
+  operator bool() const noexcept {
+    _read_epoch::guard guard(ep);
+    const function_type *p = fp.load();
+    return p && *p;
+  }
+
+  Ret operator()(Args... args) const {
+    _read_epoch::guard guard(ep);
+    return (*fp.load())(forward<Args>(args)...);
+  }
+
+ private:
+  function_type *retire(function_type *p) {
+    function_type *old = fp.exchange(p);
+    ep.synchronize();
+    return old;
+  }
+
+  atomic<function_type *> fp = nullptr;
+  _read_epoch ep;
+};
+
+template <class T>
+atomic_function(T) -> atomic_function<functraits_t<T>>;
+
+// member function with compile-time target
+
+template <auto MFP> requires is_memfunc_v<decltype(MFP)>
+struct memfunc {
+  using type = decltype(MFP);
+
+  template <class Arg0, class... Args>
+    requires is_invocable_v<type, Arg0, Args...>
+  constexpr funcret_t<type> operator()(Arg0 &&arg0, Args &&...args) const
+    noexcept(bool(funcqual_of_v<mffunction_t<type>> &
+                  +funcqual_mask::noexcept_mask)) {
+    if constexpr (is_pointer_v<decay_t<Arg0>>)
+      return (forward<Arg0>(arg0)->*MFP)(forward<Args>(args)...);
+    else return (forward<Arg0>(arg0).*MFP)(forward<Args>(args)...);
+  }
+};
+
+template <auto MFP>
+inline constexpr memfunc<MFP> memfunc_v{};
+
+// delegate
+
+template <class>
+class delegate;
+
+template <class Ret, class... Args, bool Noexcept>
+class delegate<Ret(Args...) noexcept(Noexcept)> {
+ public:
+  delegate() noexcept = default;
+  delegate(const delegate &) noexcept = default;
+  delegate(delegate &&) noexcept = default;
+  ~delegate() noexcept = default;
+  delegate &operator=(const delegate &) noexcept = default;
+  delegate &operator=(delegate &&) noexcept = default;
+
+  template <auto MFP, class T>
+    requires (Noexcept
+      ? is_nothrow_invocable_r_v<Ret, memfunc<MFP>, T *, Args...>
+      : is_invocable_r_v<Ret, memfunc<MFP>, T *, Args...>)
+  static delegate bind(T *obj) noexcept {
+    return {const_cast<void *>(static_cast<const volatile void *>(obj)),
+            &stub<MFP, T>};
+  }
+
+  operator bool() const noexcept { return _stub; }
+  bool operator==(const delegate &) const noexcept = default;
+
+  Ret operator()(Args... args) const noexcept(Noexcept) {
+    return _stub(_obj, forward<Args>(args)...);
+  }
+
+ private:
+  using stub_type = Ret (*)(void *, Args...) noexcept(Noexcept);
+
+  delegate(void *obj, stub_type s) noexcept : _obj(obj), _stub(s) {}
+
+  template <auto MFP, class T>
+  static Ret stub(void *obj, Args... args)
+    noexcept(is_nothrow_invocable_v<memfunc<MFP>, T *, Args...>) {
+    return memfunc<MFP>{}(static_cast<T *>(obj), forward<Args>(args)...);
+  }
+
+  void *_obj = nullptr;
+  stub_type _stub = nullptr;
+};
+
+template <class T, bool Noexcept>
+struct _delegate_signature;
+
+template <class Ret, class... Args, bool Noexcept>
+struct _delegate_signature<Ret(Args...), Noexcept> {
+  using type = Ret(Args...) noexcept(Noexcept);
+};
+
+template <auto MFP, class T> requires is_memfunc_v<decltype(MFP)>
+auto make_delegate(T *obj) noexcept {
+  using function_type = mffunction_t<decltype(MFP)>;
+  return delegate<typename _delegate_signature<
+    funcqual_decay_t<function_type>,
+    bool(funcqual_of_v<function_type> & +funcqual_mask::noexcept_mask)>::type>
+    ::template bind<MFP>(obj);
+}
+
+template <auto MFP, class T> requires is_memfunc_v<decltype(MFP)>
+auto make_delegate(T &obj) noexcept { return make_delegate<MFP>(&obj); }
+
 // multi function
 
 template <class... T>
@@ -288,12 +521,98 @@ class getter {
 template <class T>
 getter(T) -> getter<funcret_t<T>>;
 
+template <class Ret>
+class cached_getter {
+ public:
+  using value_type = remove_cvref_t<Ret>;
+
+  template <class T> requires (!is_same_v<decay_t<T>, cached_getter>)
+  cached_getter(T &&f) : g(forward<T>(f)) {}
+
+  cached_getter() = delete;
+  cached_getter(const cached_getter &) = delete;
+  cached_getter(cached_getter &&) = delete;
+  ~cached_getter() noexcept { release(cache.load()); }
+  cached_getter &operator=(const cached_getter &) = delete;
+  cached_getter &operator=(cached_getter &&) = delete;
+  operator value_type() const { return get(); }
+
+  // A cached read is an acquire load of the snapshot plus a copy, pinned by
+  // a _read_epoch reader count shared by all readers of this getter.
+  value_type get() const {
+    {
+      _read_epoch::guard guard(ep);
+      const value_type *p = cache.load(memory_order_acquire);
+      if (p && p != computing()) return *p;
+    }
+    lock_guard lock(m);
+    for (;;) {
+      {
+        _read_epoch::guard guard(ep);
+        if (const value_type *p = cache.load(memory_order_acquire)) return *p;
+      }
+      cache.store(computing(), memory_order_release);
+      const value_type *p;
+      try {
+        p = new value_type(g());
+      } catch (...) {
+        const value_type *expected = computing();
+        cache.compare_exchange_strong(expected, nullptr);
+        throw;
+      }
+      value_type ret = *p;
+      const value_type *expected = computing();
+      if (cache.compare_exchange_strong(expected, p, memory_order_acq_rel))
+        return ret;
+      delete p;
+    }
+  }
+
+  void invalidate() const {
+    const value_type *p = cache.exchange(nullptr, memory_order_acq_rel);
+    if (p && p != computing()) {
+      ep.synchronize();
+      delete p;
+    }
+  }
+
+  bool is_cached() const noexcept {
+    const value_type *p = cache.load(memory_order_acquire);
+    return p && p != computing();
+  }
+ private:
+  std::function<Ret()> g;
+  mutable atomic<const value_type *> cache = nullptr;
+  mutable mutex m;
+  _read_epoch ep;
+
+  alignas(value_type) static inline const char computing_tag = 0;
+
+  static const value_type *computing() noexcept {
+    return reinterpret_cast<const value_type *>(&computing_tag);
+  }
+
+  static void release(const value_type *p) noexcept {
+    if (p != computing()) delete p;
+  }
+};
+
+template <class T>
+cached_getter(T) -> cached_getter<funcret_t<T>>;
+
 template <class Arg>
 class setter {
  public:
   template <class T> requires (!is_same_v<decay_t<T>, setter>)
   setter(T &&s) : s(forward<T>(s)) {}
 
+  template <class T, class... C> requires (sizeof...(C) > 0)
+  setter(T &&s, const cached_getter<C> &...deps)
+    : s([s = forward<T>(s), ...deps = &deps](Arg arg) mutable {
+        s(forward<Arg>(arg));
+        (deps->invalidate(), ...);
+      }) {}
+
   setter() = delete;
   setter(const setter &) = delete;
   setter(setter &&) = delete;
@@ -305,8 +624,8 @@ class setter {
   std::function<void(Arg)> s;
 };
 
-template <class T>
-setter(T) -> setter<funcarg_t<T, 0>>;
+template <class T, class... C>
+setter(T, const cached_getter<C> &...) -> setter<funcarg_t<T, 0>>;
 
 template <class Ret, class Arg>
 class getset {
@@ -314,6 +633,14 @@ class getset {
   template <class G, class S>
   getset(G &&g, S &&s) : g(forward<G>(g)), s(forward<S>(s)) {}
 
+  template <class G, class S, class... C> requires (sizeof...(C) > 0)
+  getset(G &&g, S &&s, const cached_getter<C> &...deps)
+    : g(forward<G>(g)),
+      s([s = forward<S>(s), ...deps = &deps](Arg arg) mutable {
+        s(forward<Arg>(arg));
+        (deps->invalidate(), ...);
+      }) {}
+
   getset() = delete;
   getset(const getset &) = delete;
   getset(getset &&) = delete;
@@ -327,8 +654,9 @@ class getset {
   std::function<void(Arg)> s;
 };
 
-template <class G, class S>
-getset(G, S) -> getset<funcret_t<G>, funcarg_t<S, 0>>;
+template <class G, class S, class... C>
+getset(G, S, const cached_getter<C> &...)
+  -> getset<funcret_t<G>, funcarg_t<S, 0>>;
 
 // auto return
 
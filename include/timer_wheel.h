@@ -0,0 +1,253 @@
+// XH-CppUtilities
+// C++20 timer_wheel.h
+// Author: xupeigong@sjtu.edu.cn
+// Last Updated: 2026-10-19
+
+#ifndef _XH_TIMER_WHEEL_H_
+#define _XH_TIMER_WHEEL_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "function_utility.h"
+
+namespace xh {
+
+using namespace std;
+
+// timer wheel
+
+class timer_wheel {
+ public:
+  using callback_type = xh::function<void()>;
+
+  class handle {
+   public:
+    handle() noexcept = default;
+    operator bool() const noexcept { return index != npos; }
+    bool operator==(const handle &) const noexcept = default;
+   private:
+    friend class timer_wheel;
+    handle(uint32_t index, uint32_t generation) noexcept
+      : index(index), generation(generation) {}
+    uint32_t index = npos;
+    uint32_t generation = 0;
+  };
+
+  explicit timer_wheel(uint64_t now = 0) noexcept : _now(now) {
+    _slots.fill(npos);
+  }
+
+  timer_wheel(const timer_wheel &) = delete;
+  timer_wheel(timer_wheel &&r) noexcept
+    : _nodes(move(r._nodes)), _slots(r._slots), _counts(r._counts),
+      _pending(r._pending), _free(r._free), _now(r._now), _size(r._size) {
+    r.reset();
+  }
+
+  ~timer_wheel() noexcept = default;
+  timer_wheel &operator=(const timer_wheel &) = delete;
+
+  timer_wheel &operator=(timer_wheel &&r) noexcept {
+    if (this != &r) {
+      _nodes = move(r._nodes);
+      _slots = r._slots;
+      _counts = r._counts;
+      _pending = r._pending;
+      _free = r._free;
+      _now = r._now;
+      _size = r._size;
+      r.reset();
+    }
+    return *this;
+  }
+
+  uint64_t now() const noexcept { return _now; }
+  size_t size() const noexcept { return _size; }
+  bool empty() const noexcept { return !_size; }
+  void reserve(size_t n) { _nodes.reserve(n); }
+
+  handle schedule(uint64_t delay, callback_type cb) {
+    return schedule_at(_now + delay, move(cb));
+  }
+
+  handle schedule_at(uint64_t when, callback_type cb) {
+    uint32_t i = alloc();
+    _nodes[i].cb = move(cb);
+    _nodes[i].expires = when;
+    link(i, _now + 1);
+    ++_size;
+    return {i, _nodes[i].generation};
+  }
+
+  bool contains(handle h) const noexcept {
+    return h.index < _nodes.size() &&
+      _nodes[h.index].generation == h.generation &&
+      _nodes[h.index].slot != free_slot;
+  }
+
+  bool cancel(handle h) noexcept {
+    if (!contains(h)) return false;
+    unlink(h.index);
+    release(h.index);
+    --_size;
+    return true;
+  }
+
+  size_t tick(uint64_t n = 1) { return advance_to(_now + n); }
+
+  size_t advance_to(uint64_t when) {
+    size_t fired = 0;
+    while (_now < when) {
+      if (!_size) {
+        _now = when;
+        break;
+      }
+      size_t idle = 0;
+      while (idle < levels && !_counts[idle]) ++idle;
+      if (idle) {
+        uint64_t last = _now | ((uint64_t{1} << (slot_bits * idle)) - 1);
+        if (last >= when) {
+          _now = when;
+          break;
+        }
+        _now = last;
+      }
+      ++_now;
+      cascade();
+      fired += expire(_slots[_now & slot_mask]);
+    }
+    return fired;
+  }
+
+ private:
+  static constexpr uint32_t npos = UINT32_MAX;
+  static constexpr size_t slot_bits = 8;
+  static constexpr size_t slot_count = size_t{1} << slot_bits;
+  static constexpr size_t slot_mask = slot_count - 1;
+  static constexpr size_t levels = 4;
+  static constexpr uint64_t max_delta =
+    (uint64_t{1} << (slot_bits * levels)) - 1;
+  static constexpr uint32_t pending_slot = levels * slot_count;
+  static constexpr uint32_t free_slot = pending_slot + 1;
+
+  struct node {
+    callback_type cb;
+    uint64_t expires = 0;
+    uint32_t prev = npos;
+    uint32_t next = npos;
+    uint32_t slot = free_slot;
+    uint32_t generation = 0;
+  };
+
+  vector<node> _nodes;
+  array<uint32_t, levels * slot_count> _slots;
+  array<size_t, levels> _counts = {};
+  uint32_t _pending = npos;
+  uint32_t _free = npos;
+  uint64_t _now;
+  size_t _size = 0;
+
+  void reset() noexcept {
+    _nodes.clear();
+    _slots.fill(npos);
+    _counts = {};
+    _pending = _free = npos;
+    _size = 0;
+  }
+
+  uint32_t &head(uint32_t slot) noexcept {
+    return slot == pending_slot ? _pending : _slots[slot];
+  }
+
+  uint32_t alloc() {
+    if (_free == npos) {
+      _nodes.emplace_back();
+      return static_cast<uint32_t>(_nodes.size() - 1);
+    }
+    uint32_t i = _free;
+    _free = _nodes[i].next;
+    return i;
+  }
+
+  void release(uint32_t i) noexcept {
+    node &n = _nodes[i];
+    n.cb = callback_type{};
+    n.slot = free_slot;
+    ++n.generation;
+    n.prev = npos;
+    n.next = _free;
+    _free = i;
+  }
+
+  void push(uint32_t slot, uint32_t i) noexcept {
+    uint32_t &h = head(slot);
+    node &n = _nodes[i];
+    n.slot = slot;
+    n.prev = npos;
+    n.next = h;
+    if (h != npos) _nodes[h].prev = i;
+    h = i;
+    if (slot < pending_slot) ++_counts[slot / slot_count];
+  }
+
+  void unlink(uint32_t i) noexcept {
+    node &n = _nodes[i];
+    if (n.prev != npos) _nodes[n.prev].next = n.next;
+    else head(n.slot) = n.next;
+    if (n.next != npos) _nodes[n.next].prev = n.prev;
+    if (n.slot < pending_slot) --_counts[n.slot / slot_count];
+  }
+
+  void link(uint32_t i, uint64_t earliest) noexcept {
+    uint64_t expires = _nodes[i].expires;
+    if (expires < earliest) expires = earliest;
+    uint64_t delta = expires - _now;
+    if (delta > max_delta) expires = _now + max_delta, delta = max_delta;
+    size_t level = 0;
+    while (delta >> (slot_bits * (level + 1))) ++level;
+    size_t slot = (expires >> (slot_bits * level)) & slot_mask;
+    push(static_cast<uint32_t>(level * slot_count + slot), i);
+  }
+
+  void cascade() noexcept {
+    for (size_t level = 1; level < levels; ++level) {
+      if ((_now >> (slot_bits * (level - 1))) & slot_mask) break;
+      size_t slot = (_now >> (slot_bits * level)) & slot_mask;
+      uint32_t i = exchange(_slots[level * slot_count + slot], npos);
+      for (uint32_t j = i; j != npos; j = _nodes[j].next) --_counts[level];
+      while (i != npos) {
+        uint32_t next = _nodes[i].next;
+        link(i, _now);
+        i = next;
+      }
+    }
+  }
+
+  size_t expire(uint32_t &slot) {
+    size_t fired = 0;
+    for (uint32_t i = exchange(slot, npos); i != npos;) {
+      uint32_t next = _nodes[i].next;
+      --_counts[0];
+      push(pending_slot, i);
+      i = next;
+    }
+    while (_pending != npos) {
+      uint32_t i = _pending;
+      unlink(i);
+      callback_type cb = move(_nodes[i].cb);
+      release(i);
+      --_size;
+      ++fired;
+      if (cb) cb();
+    }
+    return fired;
+  }
+};
+
+} // namespace xh
+
+#endif // !_XH_TIMER_WHEEL_H_